@@ -0,0 +1,137 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <random>
+#include <thread>
+#include "implementation.hpp"
+#include "simulator.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static std::atomic<long long> heap_allocs{0};
+
+void *operator new(std::size_t n) {
+    heap_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t n, std::align_val_t al) {
+    heap_allocs.fetch_add(1, std::memory_order_relaxed);
+    std::size_t a = (std::size_t)al;
+    std::size_t size = n ? (n + a - 1) / a * a : a;
+    if (void *p = std::aligned_alloc(a, size)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+static double seconds_since(Clock::time_point t0) {
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+void bench_ring(int n) {
+    SpscRing<Task> ring(1 << 16);
+    auto t0 = Clock::now();
+    std::thread producer([&]{
+        for (int i = 0; i < n; i++) {
+            Task t(i, i, 1);
+            while (!ring.try_push(t)) std::this_thread::yield();
+        }
+    });
+    long long sum = 0;
+    int got = 0;
+    while (got < n) {
+        int k = ring.consume_all([&](const Task &t){ sum += t.arrival; });
+        if (k == 0) std::this_thread::yield();
+        got += k;
+    }
+    producer.join();
+    double s = seconds_since(t0);
+    std::cout << "ring:        " << n << " tasks in " << s << " s  ("
+              << n / s / 1e6 << " M/s, checksum " << sum << ")\n";
+}
+
+void bench_live(int n) {
+    FCFS fcfs;
+    Simulation sim(fcfs, 1 << 16);
+    auto t0 = Clock::now();
+    std::thread producer([&]{
+        for (int i = 0; i < n; i++) {
+            Task t(i, i, 1);
+            while (!sim.offer(t)) std::this_thread::yield();
+        }
+        sim.close();
+    });
+    while (!sim.done()) {
+        int before = sim.now();
+        sim.advance_until(before + 4096);
+        if (sim.now() == before) std::this_thread::yield();
+    }
+    producer.join();
+    double s = seconds_since(t0);
+    Metrics m = sim.metrics();
+    std::cout << "live replay: " << m.finished << " tasks in " << s << " s  ("
+              << m.finished / s / 1e6 << " M/s, " << m.now << " ticks, avg waiting "
+              << m.avg_waiting << ")\n";
+}
+
+template <typename Run>
+void report_runs(const char *label, int runs, Run &&run) {
+    run();
+    long long a0 = heap_allocs.load();
+    auto t0 = Clock::now();
+    for (int i = 0; i < runs; i++) run();
+    double s = seconds_since(t0);
+    std::cout << "  " << label << s / runs * 1e6 << " us/run, "
+              << (double)(heap_allocs.load() - a0) / runs << " heap allocs/run\n";
+}
+
+void bench_reuse(int n, int runs) {
+    std::mt19937 gen(42);
+    std::vector<Task> tasks;
+    int max_time = 0;
+    for (int i = 0; i < n; i++) {
+        tasks.emplace_back(i + 1, gen() % (n * 2), 1 + gen() % 8);
+        max_time += tasks.back().burst;
+    }
+    max_time += n * 2;
+
+    std::unordered_map<int,int> bm;
+    for (auto &t : tasks) bm[t.pid] = t.burst;
+
+    SimulationContext ctx;
+    FCFS fcfs(ctx.resource());
+    RoundRobin rr(2, ctx.resource());
+    SJF sjf(ctx.resource());
+    sjf.set_bursts(bm);
+    SRTF srtf(ctx.resource());
+
+    auto sweep = [&](const char *name, Scheduler &pooled, auto make) {
+        std::cout << name << " (" << n << " tasks)\n";
+        report_runs("simulate():          ", runs, [&]{
+            auto sched = make();
+            simulate(tasks, sched, max_time);
+        });
+        report_runs("SimulationContext:   ", runs, [&]{
+            ctx.run(tasks, pooled, max_time);
+        });
+    };
+    sweep("FCFS", fcfs, []{ return FCFS(); });
+    sweep("RR q=2", rr, []{ return RoundRobin(2); });
+    sweep("SJF", sjf, [&]{ SJF s; s.set_bursts(bm); return s; });
+    sweep("SRTF", srtf, []{ return SRTF(); });
+}
+
+int main(int argc, char **argv) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 2000000;
+    bench_ring(n);
+    bench_live(n);
+    bench_reuse(2000, 200);
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include "trace.hpp"
+#include "protocol.hpp"
+
+static void usage(const char *argv0) {
+    std::cerr << "usage: " << argv0 << " [-s socket] (-t trace | -i 'pid,arrival,burst;...')\n"
+              << "       [-a fcfs|rr|sjf|srtf] [-q quantum] [-m max_time] [-o metrics,schedule,tasks]\n";
+}
+
+static void print_metrics(const proto::Metrics &m) {
+    std::cout << "Total Time: " << m.total_ticks << "\n";
+    std::cout << "Average Waiting Time: " << m.avg_waiting << "\n";
+    std::cout << "Average Turnaround Time: " << m.avg_turnaround << "\n";
+    std::cout << "Average Response Time: " << m.avg_response << "\n";
+    std::cout << "CPU Utilization: " << m.cpu_utilization << "%\n";
+    std::cout << "Throughput: " << m.throughput << " tasks/unit time\n";
+    std::cout << "Context Switches: " << m.context_switches << "\n";
+}
+
+int main(int argc, char **argv) {
+    std::string socket_path = proto::default_socket;
+    proto::Request req;
+    bool have_workload = false;
+
+    int opt;
+    while ((opt = ::getopt(argc, argv, "s:t:i:a:q:m:o:h")) != -1) {
+        switch (opt) {
+        case 's':
+            socket_path = optarg;
+            break;
+        case 't': {
+            // the daemon has its own working directory, so send an absolute path
+            char resolved[PATH_MAX];
+            if (!::realpath(optarg, resolved)) {
+                std::cerr << "cannot open trace " << optarg << "\n";
+                return 1;
+            }
+            req.source = proto::SourceTrace;
+            req.path = resolved;
+            have_workload = true;
+            break;
+        }
+        case 'i': {
+            std::string text = optarg;
+            std::replace(text.begin(), text.end(), ';', '\n');
+            try {
+                parse_trace(text, req.tasks);
+            } catch (const std::runtime_error &e) {
+                std::cerr << e.what() << "\n";
+                return 1;
+            }
+            req.source = proto::SourceInline;
+            have_workload = true;
+            break;
+        }
+        case 'a':
+            if (!proto::parse_algo(optarg, req.algo)) { usage(argv[0]); return 1; }
+            break;
+        case 'q':
+            req.quantum = std::atoi(optarg);
+            break;
+        case 'm':
+            req.max_time = std::atoi(optarg);
+            break;
+        case 'o':
+            if (!proto::parse_outputs(optarg, req.outputs)) { usage(argv[0]); return 1; }
+            break;
+        default:
+            usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (!have_workload) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    int fd = proto::connect_socket(socket_path);
+    if (fd < 0) {
+        std::cerr << "cannot connect to " << socket_path << "\n";
+        return 1;
+    }
+
+    proto::Writer w;
+    proto::encode_request(w, req);
+    if (!proto::send_frame(fd, w)) {
+        std::cerr << "send failed\n";
+        return 1;
+    }
+
+    uint8_t kind;
+    std::string payload;
+    while (proto::read_frame(fd, kind, payload)) {
+        proto::Reader r(payload);
+        switch (kind) {
+        case proto::KindMetrics:
+            print_metrics(proto::decode_metrics(payload));
+            break;
+        case proto::KindEvents: {
+            uint32_t n = r.get<uint32_t>();
+            for (uint32_t i = 0; i < n && r.good(); i++) {
+                int time = r.get<int32_t>();
+                int pid = r.get<int32_t>();
+                uint8_t type = r.get<uint8_t>();
+                std::cout << "t=" << time << " pid=" << pid << " " << proto::event_name(type) << "\n";
+            }
+            break;
+        }
+        case proto::KindTasks: {
+            uint32_t n = r.get<uint32_t>();
+            for (uint32_t i = 0; i < n && r.good(); i++) {
+                int v[8];
+                for (int &x : v) x = r.get<int32_t>();
+                std::cout << "pid=" << v[0] << " arrival=" << v[1] << " burst=" << v[2]
+                          << " start=" << v[3] << " completion=" << v[4] << " response=" << v[5]
+                          << " waiting=" << v[6] << " turnaround=" << v[7] << "\n";
+            }
+            break;
+        }
+        case proto::KindError:
+            std::cerr << "error: " << r.get_string() << "\n";
+            ::close(fd);
+            return 1;
+        case proto::KindEnd:
+            ::close(fd);
+            return 0;
+        }
+    }
+
+    std::cerr << "connection closed before the response ended\n";
+    ::close(fd);
+    return 1;
+}
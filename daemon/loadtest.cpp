@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "protocol.hpp"
+
+using Clock = std::chrono::steady_clock;
+
+static void usage(const char *argv0) {
+    std::cerr << "usage: " << argv0 << " -t trace [-s socket] [-c connections] [-n requests]\n"
+              << "       [-a fcfs|rr|sjf|srtf] [-q quantum] [-m max_time] [-o metrics,schedule,tasks]\n";
+}
+
+// Sends the same query n times over one connection, recording each round trip.
+static bool hammer(const std::string &socket_path, const proto::Request &req, int n,
+                   std::vector<double> &latencies) {
+    int fd = proto::connect_socket(socket_path);
+    if (fd < 0) return false;
+
+    proto::Writer w;
+    std::string payload;
+    uint8_t kind;
+    for (int i = 0; i < n; i++) {
+        auto t0 = Clock::now();
+        proto::encode_request(w, req);
+        if (!proto::send_frame(fd, w)) break;
+        do {
+            if (!proto::read_frame(fd, kind, payload)) kind = proto::KindError;
+        } while (kind != proto::KindEnd && kind != proto::KindError);
+        if (kind == proto::KindError) break;
+        latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - t0).count());
+    }
+    ::close(fd);
+    return (int)latencies.size() == n;
+}
+
+int main(int argc, char **argv) {
+    std::string socket_path = proto::default_socket;
+    proto::Request req;
+    req.source = proto::SourceTrace;
+    int connections = 4;
+    int requests = 10000;
+
+    int opt;
+    while ((opt = ::getopt(argc, argv, "s:t:c:n:a:q:m:o:h")) != -1) {
+        switch (opt) {
+        case 's': socket_path = optarg; break;
+        case 't': {
+            char resolved[PATH_MAX];
+            req.path = ::realpath(optarg, resolved) ? resolved : optarg;
+            break;
+        }
+        case 'c': connections = std::max(1, std::atoi(optarg)); break;
+        case 'n': requests = std::max(1, std::atoi(optarg)); break;
+        case 'a':
+            if (!proto::parse_algo(optarg, req.algo)) { usage(argv[0]); return 1; }
+            break;
+        case 'q': req.quantum = std::atoi(optarg); break;
+        case 'm': req.max_time = std::atoi(optarg); break;
+        case 'o':
+            if (!proto::parse_outputs(optarg, req.outputs)) { usage(argv[0]); return 1; }
+            break;
+        default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (req.path.empty()) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    // one query up front so the daemon has parsed and cached the trace
+    std::vector<double> warm;
+    if (!hammer(socket_path, req, 1, warm)) {
+        std::cerr << "warm-up query failed; is the daemon running on " << socket_path << "?\n";
+        return 1;
+    }
+    std::cout << "first query: " << warm[0] << " us\n";
+
+    std::vector<std::vector<double>> per_conn(connections);
+    std::vector<std::thread> threads;
+    int per = requests / connections;
+    std::atomic<bool> ok{true};
+    auto t0 = Clock::now();
+    for (int c = 0; c < connections; c++) {
+        per_conn[c].reserve(per);
+        threads.emplace_back([&, c]{
+            if (!hammer(socket_path, req, per, per_conn[c])) ok = false;
+        });
+    }
+    for (auto &t : threads) t.join();
+    double secs = std::chrono::duration<double>(Clock::now() - t0).count();
+
+    std::vector<double> all;
+    for (auto &v : per_conn) all.insert(all.end(), v.begin(), v.end());
+    if (all.empty()) {
+        std::cerr << "no queries completed\n";
+        return 1;
+    }
+    std::sort(all.begin(), all.end());
+    auto pct = [&](double p) { return all[std::min(all.size() - 1, (size_t)(p * all.size()))]; };
+
+    std::cout << all.size() << " queries over " << connections << " connections in " << secs << " s ("
+              << all.size() / secs << " req/s)\n";
+    std::cout << "latency us: p50 " << pct(0.50) << "  p90 " << pct(0.90) << "  p99 " << pct(0.99)
+              << "  max " << all.back() << "\n";
+    if (!ok) std::cerr << "some connections failed\n";
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,210 @@
+#include "protocol.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace proto {
+
+static bool write_all(int fd, const char *p, size_t n) {
+    while (n > 0) {
+        ssize_t k = ::send(fd, p, n, MSG_NOSIGNAL);
+        if (k < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += k;
+        n -= k;
+    }
+    return true;
+}
+
+static bool read_all(int fd, char *p, size_t n) {
+    while (n > 0) {
+        ssize_t k = ::read(fd, p, n);
+        if (k < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        if (k == 0) return false;
+        p += k;
+        n -= k;
+    }
+    return true;
+}
+
+bool send_frame(int fd, Writer &w) {
+    const std::string &buf = w.finish();
+    return write_all(fd, buf.data(), buf.size());
+}
+
+bool read_frame(int fd, uint8_t &kind, std::string &payload) {
+    uint32_t len;
+    if (!read_all(fd, reinterpret_cast<char*>(&len), sizeof len)) return false;
+    if (len == 0 || len > max_frame) return false;
+    if (!read_all(fd, reinterpret_cast<char*>(&kind), 1)) return false;
+    payload.resize(len - 1);
+    return read_all(fd, payload.data(), payload.size());
+}
+
+void encode_request(Writer &w, const Request &req) {
+    w.begin(KindRequest);
+    w.put(req.algo);
+    w.put(req.outputs);
+    w.put(req.quantum);
+    w.put(req.max_time);
+    w.put(req.source);
+    if (req.source == SourceTrace) {
+        w.put_string(req.path);
+        return;
+    }
+    w.put<uint32_t>(req.tasks.size());
+    for (auto &t : req.tasks) {
+        w.put<int32_t>(t.pid);
+        w.put<int32_t>(t.arrival);
+        w.put<int32_t>(t.burst);
+    }
+}
+
+bool decode_request(const std::string &payload, Request &req) {
+    Reader r(payload);
+    req.algo = r.get<uint8_t>();
+    req.outputs = r.get<uint8_t>();
+    req.quantum = r.get<int32_t>();
+    req.max_time = r.get<int32_t>();
+    req.source = r.get<uint8_t>();
+    req.path.clear();
+    req.tasks.clear();
+    if (req.source == SourceTrace) {
+        req.path = r.get_string();
+    } else if (req.source == SourceInline) {
+        uint32_t n = r.get<uint32_t>();
+        if (!r.good() || n > payload.size() / 12) return false;
+        req.tasks.reserve(n);
+        for (uint32_t i = 0; i < n; i++) {
+            int pid = r.get<int32_t>();
+            int arrival = r.get<int32_t>();
+            int burst = r.get<int32_t>();
+            req.tasks.emplace_back(pid, arrival, burst);
+        }
+    } else {
+        return false;
+    }
+    return r.good() && r.at_end();
+}
+
+void encode_metrics(Writer &w, const Result &res) {
+    w.begin(KindMetrics);
+    w.put<int32_t>(res.total_ticks);
+    w.put<int32_t>(res.context_switches);
+    w.put<int32_t>(res.cpu_busy);
+    w.put(res.avg_waiting);
+    w.put(res.avg_turnaround);
+    w.put(res.avg_response);
+    w.put(res.cpu_utilization);
+    w.put(res.throughput);
+}
+
+Metrics decode_metrics(const std::string &payload) {
+    Reader r(payload);
+    Metrics m;
+    m.total_ticks = r.get<int32_t>();
+    m.context_switches = r.get<int32_t>();
+    m.cpu_busy = r.get<int32_t>();
+    m.avg_waiting = r.get<double>();
+    m.avg_turnaround = r.get<double>();
+    m.avg_response = r.get<double>();
+    m.cpu_utilization = r.get<double>();
+    m.throughput = r.get<double>();
+    return m;
+}
+
+uint8_t event_code(const std::string &type) {
+    if (type == "start") return EventStart;
+    if (type == "preempt") return EventPreempt;
+    return EventComplete;
+}
+
+const char *event_name(uint8_t code) {
+    switch (code) {
+    case EventStart: return "start";
+    case EventPreempt: return "preempt";
+    default: return "complete";
+    }
+}
+
+bool parse_algo(const std::string &s, uint8_t &algo) {
+    if (s == "fcfs") algo = AlgoFCFS;
+    else if (s == "rr") algo = AlgoRR;
+    else if (s == "sjf") algo = AlgoSJF;
+    else if (s == "srtf") algo = AlgoSRTF;
+    else return false;
+    return true;
+}
+
+bool parse_outputs(const std::string &s, uint8_t &outputs) {
+    outputs = 0;
+    size_t pos = 0;
+    while (pos <= s.size()) {
+        size_t comma = std::min(s.find(',', pos), s.size());
+        std::string item = s.substr(pos, comma - pos);
+        if (item == "metrics") outputs |= WantMetrics;
+        else if (item == "schedule") outputs |= WantSchedule;
+        else if (item == "tasks") outputs |= WantTasks;
+        else return false;
+        pos = comma + 1;
+    }
+    return true;
+}
+
+static bool fill_address(const std::string &path, sockaddr_un &addr) {
+    if (path.size() >= sizeof addr.sun_path) return false;
+    std::memset(&addr, 0, sizeof addr);
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+int listen_socket(const std::string &path) {
+    sockaddr_un addr;
+    if (!fill_address(path, addr)) return -1;
+
+    struct stat st;
+    if (::lstat(path.c_str(), &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            errno = EEXIST;
+            return -1;
+        }
+        int live = connect_socket(path);
+        if (live >= 0) {
+            ::close(live);
+            errno = EADDRINUSE;
+            return -1;
+        }
+        ::unlink(path.c_str());
+    }
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) < 0 || ::listen(fd, 128) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int connect_socket(const std::string &path) {
+    sockaddr_un addr;
+    if (!fill_address(path, addr)) return -1;
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+}
@@ -0,0 +1,130 @@
+#ifndef PROTOCOL_HPP
+#define PROTOCOL_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "scheduler.hpp"
+
+// Wire format shared by the daemon, client and load test. Every message is a
+// frame: u32 length of what follows, u8 kind, payload. Integers travel in
+// host byte order since the socket never leaves the machine.
+//
+// A client sends one Request frame per query; the daemon answers with the
+// sections the request asked for (Events and Tasks may span several frames)
+// and closes the answer with End, or with a single Error frame.
+namespace proto {
+
+constexpr const char *default_socket = "/tmp/cpu_scheduler.sock";
+constexpr uint32_t max_frame = 64u << 20;
+constexpr uint32_t chunk = 8192;
+
+enum Kind : uint8_t {
+    KindRequest = 1,
+    KindMetrics = 2,
+    KindEvents = 3,
+    KindTasks = 4,
+    KindEnd = 5,
+    KindError = 6,
+};
+
+enum Algo : uint8_t { AlgoFCFS = 0, AlgoRR = 1, AlgoSJF = 2, AlgoSRTF = 3 };
+enum Source : uint8_t { SourceInline = 0, SourceTrace = 1 };
+enum Output : uint8_t { WantMetrics = 1, WantSchedule = 2, WantTasks = 4 };
+enum EventType : uint8_t { EventStart = 0, EventPreempt = 1, EventComplete = 2 };
+
+struct Request {
+    uint8_t algo = AlgoFCFS;
+    uint8_t outputs = WantMetrics;
+    int32_t quantum = 2;
+    int32_t max_time = 0;   // <= 0 runs until every task completes
+    uint8_t source = SourceInline;
+    std::string path;
+    std::vector<Task> tasks;
+};
+
+struct Metrics {
+    int32_t total_ticks = 0;
+    int32_t context_switches = 0;
+    int32_t cpu_busy = 0;
+    double avg_waiting = 0;
+    double avg_turnaround = 0;
+    double avg_response = 0;
+    double cpu_utilization = 0;
+    double throughput = 0;
+};
+
+// Builds one frame in a reusable buffer.
+class Writer {
+    std::string buf;
+public:
+    void begin(uint8_t kind) {
+        buf.assign(4, '\0');
+        put(kind);
+    }
+    template <typename T>
+    void put(T v) { buf.append(reinterpret_cast<const char*>(&v), sizeof v); }
+    void put_string(const std::string &s) {
+        put<uint32_t>(s.size());
+        buf.append(s);
+    }
+    const std::string &finish() {
+        uint32_t len = buf.size() - 4;
+        std::memcpy(buf.data(), &len, 4);
+        return buf;
+    }
+};
+
+// Reads a frame payload; any overrun clears good() instead of throwing.
+class Reader {
+    const char *p;
+    const char *end;
+    bool ok = true;
+public:
+    explicit Reader(const std::string &payload) : p(payload.data()), end(p + payload.size()) {}
+    template <typename T>
+    T get() {
+        T v{};
+        if (end - p < (long)sizeof v) { ok = false; return v; }
+        std::memcpy(&v, p, sizeof v);
+        p += sizeof v;
+        return v;
+    }
+    std::string get_string() {
+        uint32_t n = get<uint32_t>();
+        if (!ok || (uint32_t)(end - p) < n) { ok = false; return {}; }
+        std::string s(p, n);
+        p += n;
+        return s;
+    }
+    bool good() const { return ok; }
+    bool at_end() const { return p == end; }
+};
+
+bool send_frame(int fd, Writer &w);
+// Returns false on EOF, I/O error or an oversized frame.
+bool read_frame(int fd, uint8_t &kind, std::string &payload);
+
+void encode_request(Writer &w, const Request &req);
+bool decode_request(const std::string &payload, Request &req);
+
+void encode_metrics(Writer &w, const Result &res);
+Metrics decode_metrics(const std::string &payload);
+
+// Command-line spellings: "fcfs", "rr", "sjf", "srtf" and a comma-separated
+// list of "metrics", "schedule", "tasks".
+bool parse_algo(const std::string &s, uint8_t &algo);
+bool parse_outputs(const std::string &s, uint8_t &outputs);
+
+uint8_t event_code(const std::string &type);
+const char *event_name(uint8_t code);
+
+// Only a stale socket is replaced. Fails with EEXIST if path is some other
+// kind of file and with EADDRINUSE if a daemon still accepts on it.
+int listen_socket(const std::string &path);
+int connect_socket(const std::string &path);
+
+}
+
+#endif
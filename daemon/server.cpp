@@ -0,0 +1,379 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <thread>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include "implementation.hpp"
+#include "simulator.hpp"
+#include "trace.hpp"
+#include "protocol.hpp"
+
+struct Workload {
+    std::vector<Task> tasks;
+    std::unordered_map<int,int> bursts;
+    int horizon = 0;
+};
+
+static void fill_bursts(Workload &w) {
+    w.bursts.clear();
+    for (auto &t : w.tasks) w.bursts[t.pid] = t.burst;
+}
+
+// Parsed traces stay resident, keyed by canonical path and revalidated
+// against the file's size and mtime so an edited trace is picked up on the
+// next request.
+class WorkloadCache {
+    struct Entry {
+        std::shared_ptr<const Workload> workload;
+        off_t size;
+        struct timespec mtime;
+    };
+    std::shared_mutex mu;
+    std::unordered_map<std::string, Entry> entries;
+
+    static bool same(const Entry &e, const struct stat &st) {
+        return e.size == st.st_size && e.mtime.tv_sec == st.st_mtim.tv_sec
+            && e.mtime.tv_nsec == st.st_mtim.tv_nsec;
+    }
+
+public:
+    std::shared_ptr<const Workload> get(const std::string &path) {
+        char resolved[PATH_MAX];
+        struct stat st;
+        if (!::realpath(path.c_str(), resolved) || ::stat(resolved, &st) != 0)
+            throw std::runtime_error("cannot open trace " + path);
+        std::string key = resolved;
+        {
+            std::shared_lock lock(mu);
+            auto it = entries.find(key);
+            if (it != entries.end() && same(it->second, st)) return it->second.workload;
+        }
+
+        auto w = std::make_shared<Workload>();
+        w->tasks = load_trace(key);
+        fill_bursts(*w);
+        w->horizon = completion_horizon(w->tasks);
+
+        std::unique_lock lock(mu);
+        entries[key] = {w, st.st_size, st.st_mtim};
+        return w;
+    }
+};
+
+// Per-worker state; everything here is reused from one request to the next.
+struct Worker {
+    SimulationContext ctx;
+    proto::Request req;
+    proto::Writer out;
+    std::string payload;
+    Workload inline_workload;
+};
+
+static bool send_error(int fd, proto::Writer &w, const std::string &msg) {
+    w.begin(proto::KindError);
+    w.put_string(msg);
+    return proto::send_frame(fd, w);
+}
+
+static const Result &run(Worker &wk, const Workload &w) {
+    const proto::Request &req = wk.req;
+    int max_time = req.max_time > 0 ? std::min(req.max_time, w.horizon) : w.horizon;
+    auto *mr = wk.ctx.resource();
+
+    switch (req.algo) {
+    case proto::AlgoRR: {
+        RoundRobin sched(req.quantum, mr);
+        return wk.ctx.run(w.tasks, sched, max_time);
+    }
+    case proto::AlgoSJF: {
+        SJF sched(mr);
+        sched.set_bursts(w.bursts);
+        return wk.ctx.run(w.tasks, sched, max_time);
+    }
+    case proto::AlgoSRTF: {
+        SRTF sched(mr);
+        return wk.ctx.run(w.tasks, sched, max_time);
+    }
+    default: {
+        FCFS sched(mr);
+        return wk.ctx.run(w.tasks, sched, max_time);
+    }
+    }
+}
+
+static bool stream(int fd, Worker &wk, const Result &res) {
+    proto::Writer &w = wk.out;
+    uint8_t outputs = wk.req.outputs;
+
+    if (outputs & proto::WantMetrics) {
+        proto::encode_metrics(w, res);
+        if (!proto::send_frame(fd, w)) return false;
+    }
+
+    if (outputs & proto::WantSchedule) {
+        for (size_t i = 0; i < res.events.size(); i += proto::chunk) {
+            size_t n = std::min<size_t>(proto::chunk, res.events.size() - i);
+            w.begin(proto::KindEvents);
+            w.put<uint32_t>(n);
+            for (size_t j = i; j < i + n; j++) {
+                auto &e = res.events[j];
+                w.put<int32_t>(e.time);
+                w.put<int32_t>(e.pid);
+                w.put(proto::event_code(e.type));
+            }
+            if (!proto::send_frame(fd, w)) return false;
+        }
+    }
+
+    if (outputs & proto::WantTasks) {
+        auto it = res.tasks.begin();
+        size_t left = res.tasks.size();
+        while (left > 0) {
+            uint32_t n = std::min<size_t>(proto::chunk, left);
+            left -= n;
+            w.begin(proto::KindTasks);
+            w.put(n);
+            for (uint32_t j = 0; j < n; j++, ++it) {
+                const Task &t = it->second;
+                w.put<int32_t>(t.pid);
+                w.put<int32_t>(t.arrival);
+                w.put<int32_t>(t.burst);
+                w.put<int32_t>(t.start_time);
+                w.put<int32_t>(t.completion_time);
+                w.put<int32_t>(t.response_time);
+                w.put<int32_t>(t.waiting_time);
+                w.put<int32_t>(t.turnaround_time);
+            }
+            if (!proto::send_frame(fd, w)) return false;
+        }
+    }
+
+    w.begin(proto::KindEnd);
+    return proto::send_frame(fd, w);
+}
+
+// Answers one request from a readable connection. Returns false when the
+// connection should be closed: the client hung up, timed out mid-frame or
+// sent something that is not a request.
+static bool serve(int fd, Worker &wk, WorkloadCache &cache) {
+    uint8_t kind;
+    if (!proto::read_frame(fd, kind, wk.payload)) return false;
+    if (kind != proto::KindRequest || !proto::decode_request(wk.payload, wk.req)) {
+        send_error(fd, wk.out, "malformed request");
+        return false;
+    }
+
+    const proto::Request &req = wk.req;
+    if (req.algo > proto::AlgoSRTF)
+        return send_error(fd, wk.out, "unknown algorithm");
+    if (req.algo == proto::AlgoRR && req.quantum < 1)
+        return send_error(fd, wk.out, "quantum must be >= 1");
+
+    std::shared_ptr<const Workload> cached;
+    const Workload *w;
+    try {
+        if (req.source == proto::SourceTrace) {
+            cached = cache.get(req.path);
+            w = cached.get();
+        } else {
+            validate_tasks(req.tasks);
+            wk.inline_workload.tasks.swap(wk.req.tasks);
+            if (req.algo == proto::AlgoSJF) fill_bursts(wk.inline_workload);
+            wk.inline_workload.horizon = completion_horizon(wk.inline_workload.tasks);
+            w = &wk.inline_workload;
+        }
+    } catch (const std::runtime_error &e) {
+        return send_error(fd, wk.out, e.what());
+    }
+
+    if (w->tasks.empty())
+        return send_error(fd, wk.out, "empty workload");
+    return stream(fd, wk, run(wk, *w));
+}
+
+// Idle connections sit in epoll and cost no thread. Each connection is
+// registered one-shot, so once it turns readable exactly one worker owns it
+// for a single request and then re-arms it.
+class WorkerPool {
+    std::mutex mu;
+    std::condition_variable cv;
+    std::deque<int> ready;
+    bool stopping = false;
+    std::vector<std::thread> threads;
+    WorkloadCache &cache;
+    int epfd;
+
+    void loop() {
+        Worker wk;
+        for (;;) {
+            int fd;
+            {
+                std::unique_lock lock(mu);
+                cv.wait(lock, [&]{ return stopping || !ready.empty(); });
+                if (stopping) return;
+                fd = ready.front();
+                ready.pop_front();
+            }
+            if (!serve(fd, wk, cache) || !arm(fd, EPOLL_CTL_MOD)) ::close(fd);
+        }
+    }
+
+public:
+    WorkerPool(int n, WorkloadCache &c, int ep) : cache(c), epfd(ep) {
+        for (int i = 0; i < n; i++) threads.emplace_back([this]{ loop(); });
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard lock(mu);
+            stopping = true;
+        }
+        cv.notify_all();
+        for (auto &t : threads) t.join();
+        for (int fd : ready) ::close(fd);
+    }
+
+    bool arm(int fd, int op) {
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+        ev.data.fd = fd;
+        return ::epoll_ctl(epfd, op, fd, &ev) == 0;
+    }
+
+    void submit(int fd) {
+        {
+            std::lock_guard lock(mu);
+            ready.push_back(fd);
+        }
+        cv.notify_one();
+    }
+};
+
+static std::string socket_path = proto::default_socket;
+
+// Bounds how long a worker can be held by a client that stalls mid-frame
+// or stops reading its answer.
+static void set_timeouts(int fd) {
+    timeval tv{5, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof tv);
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof tv);
+}
+
+// Another daemon may have replaced the socket after this one started; only
+// the file this process bound is removed on the way out.
+static void unlink_if_same(const std::string &path, const struct stat &bound) {
+    struct stat st;
+    if (::lstat(path.c_str(), &st) == 0 && st.st_dev == bound.st_dev && st.st_ino == bound.st_ino)
+        ::unlink(path.c_str());
+}
+
+static void usage(const char *argv0) {
+    std::cerr << "usage: " << argv0 << " [-s socket] [-w workers]\n";
+}
+
+int main(int argc, char **argv) {
+    int workers = std::max(2u, std::thread::hardware_concurrency());
+    int opt;
+    while ((opt = ::getopt(argc, argv, "s:w:h")) != -1) {
+        switch (opt) {
+        case 's': socket_path = optarg; break;
+        case 'w': workers = std::max(1, std::atoi(optarg)); break;
+        default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    // SIGINT and SIGTERM stay blocked in every thread and arrive through a
+    // signalfd in the epoll set, so one sent just before epoll_wait is not
+    // lost, nor one sent during setup.
+    sigset_t stop_signals;
+    sigemptyset(&stop_signals);
+    sigaddset(&stop_signals, SIGINT);
+    sigaddset(&stop_signals, SIGTERM);
+    ::pthread_sigmask(SIG_BLOCK, &stop_signals, nullptr);
+
+    int lfd = proto::listen_socket(socket_path);
+    if (lfd < 0) {
+        std::cerr << "cannot listen on " << socket_path << ": ";
+        if (errno == EEXIST) std::cerr << "file exists and is not a socket\n";
+        else if (errno == EADDRINUSE) std::cerr << "a daemon is already running there\n";
+        else std::cerr << std::strerror(errno) << "\n";
+        return 1;
+    }
+    struct stat bound;
+    ::lstat(socket_path.c_str(), &bound);
+
+    int sfd = ::signalfd(-1, &stop_signals, SFD_CLOEXEC);
+    int epfd = ::epoll_create1(EPOLL_CLOEXEC);
+    epoll_event lev{}, sev{};
+    lev.events = sev.events = EPOLLIN;
+    lev.data.fd = lfd;
+    sev.data.fd = sfd;
+    if (sfd < 0 || epfd < 0 || ::epoll_ctl(epfd, EPOLL_CTL_ADD, lfd, &lev) < 0
+        || ::epoll_ctl(epfd, EPOLL_CTL_ADD, sfd, &sev) < 0) {
+        std::cerr << "cannot poll " << socket_path << "\n";
+        unlink_if_same(socket_path, bound);
+        return 1;
+    }
+
+    int status = 0;
+    {
+        WorkloadCache cache;
+        WorkerPool pool(workers, cache, epfd);
+        std::cout << "listening on " << socket_path << " with " << workers << " workers" << std::endl;
+
+        epoll_event events[64];
+        bool stopping = false;
+        while (!stopping) {
+            int n = ::epoll_wait(epfd, events, 64, -1);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                std::cerr << "epoll_wait failed\n";
+                status = 1;
+                break;
+            }
+            for (int i = 0; i < n; i++) {
+                int fd = events[i].data.fd;
+                if (fd == sfd) {
+                    stopping = true;
+                    continue;
+                }
+                if (fd != lfd) {
+                    pool.submit(fd);
+                    continue;
+                }
+
+                int cfd = ::accept4(lfd, nullptr, nullptr, SOCK_CLOEXEC);
+                if (cfd < 0) {
+                    if (errno == EINTR || errno == EAGAIN || errno == ECONNABORTED) continue;
+                    // out of descriptors or memory: back off until connections close
+                    std::cerr << "accept failed, retrying\n";
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    continue;
+                }
+                set_timeouts(cfd);
+                if (!pool.arm(cfd, EPOLL_CTL_ADD)) ::close(cfd);
+            }
+        }
+    }
+
+    unlink_if_same(socket_path, bound);
+    return status;
+}
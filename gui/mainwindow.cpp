@@ -11,6 +11,8 @@
 #include <QPdfWriter>
 #include "implementation.hpp"
 #include "simulator.hpp"
+#include "trace.hpp"
+#include <stdexcept>
 
 MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
     QWidget *central = new QWidget(this);
@@ -47,20 +49,34 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
     mainLayout->addLayout(controls);
 
     auto *procLayout = new QHBoxLayout();
-    procTable_ = new QTableWidget(0, 3);
-    procTable_->setHorizontalHeaderLabels({"PID", "Arrival Time", "Burst Time"});
+    procModel_ = new ProcessModel(this);
+    procTable_ = new QTableView();
+    procTable_->setModel(procModel_);
     procTable_->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    procTable_->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    procTable_->verticalHeader()->setDefaultSectionSize(procTable_->fontMetrics().height() + 6);
     procTable_->setEditTriggers(QAbstractItemView::AllEditTriggers);
     procTable_->setSelectionBehavior(QAbstractItemView::SelectRows);
-    procTable_->setSelectionMode(QAbstractItemView::SingleSelection);
+    procTable_->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    procTable_->setSortingEnabled(true);
     procTable_->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::MinimumExpanding);
     procLayout->addWidget(procTable_);
 
     auto *procBtns = new QVBoxLayout();
     addRowBtn_ = new QPushButton("Add Process");
     delRowBtn_ = new QPushButton("Delete Selected");
+    importBtn_ = new QPushButton("Import Trace");
     procBtns->addWidget(addRowBtn_);
     procBtns->addWidget(delRowBtn_);
+    procBtns->addWidget(importBtn_);
+    procBtns->addSpacing(10);
+    procBtns->addWidget(new QLabel("Filter:"));
+    filterColumn_ = new QComboBox();
+    filterColumn_->addItems({"PID", "Arrival Time", "Burst Time"});
+    procBtns->addWidget(filterColumn_);
+    filterEdit_ = new QLineEdit();
+    filterEdit_->setPlaceholderText("e.g. 10 or 0-100");
+    procBtns->addWidget(filterEdit_);
     procBtns->addStretch(1);
     procLayout->addLayout(procBtns);
     mainLayout->addLayout(procLayout);
@@ -101,6 +117,9 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
     connect(algoCombo_, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::onAlgoChanged);
     connect(addRowBtn_, &QPushButton::clicked, this, &MainWindow::onAddProcess);
     connect(delRowBtn_, &QPushButton::clicked, this, &MainWindow::onDeleteProcess);
+    connect(importBtn_, &QPushButton::clicked, this, &MainWindow::onImportTrace);
+    connect(filterEdit_, &QLineEdit::textChanged, this, &MainWindow::onFilterChanged);
+    connect(filterColumn_, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::onFilterChanged);
 
     onAlgoChanged(algoCombo_->currentIndex());
 }
@@ -112,50 +131,80 @@ void MainWindow::onAlgoChanged(int idx) {
 }
 
 void MainWindow::onAddProcess() {
-    int row = procTable_->rowCount();
-    procTable_->insertRow(row);
-    procTable_->setItem(row, 0, new QTableWidgetItem(QString::number(row + 1)));
-    procTable_->setItem(row, 1, new QTableWidgetItem("0"));
-    procTable_->setItem(row, 2, new QTableWidgetItem("1"));
+    procModel_->appendTask(Task(procModel_->nextPid(), 0, 1));
+    if (!procModel_->isFiltered())
+        procTable_->scrollToBottom();
 }
 
 void MainWindow::onDeleteProcess() {
-    int row = procTable_->currentRow();
-    if (row >= 0)
-        procTable_->removeRow(row);
+    std::vector<int> rows;
+    for (const QModelIndex &idx : procTable_->selectionModel()->selectedRows())
+        rows.push_back(idx.row());
+    procModel_->removeTaskRows(std::move(rows));
 }
 
-void MainWindow::onRunClicked() {
+void MainWindow::onImportTrace() {
+    QString fileName = QFileDialog::getOpenFileName(this, "Import Trace", "", "Trace Files (*.csv *.txt *.trace);;All Files (*)");
+    if (fileName.isEmpty()) return;
+
     std::vector<Task> tasks;
+    try {
+        tasks = load_trace(fileName.toStdString());
+    } catch (const std::runtime_error &e) {
+        QMessageBox::warning(this, "Import Failed", QString::fromStdString(e.what()));
+        return;
+    }
+    if (procModel_->sharesPids(tasks)) {
+        QMessageBox::warning(this, "Import Failed", "The trace reuses PIDs that are already in the table.");
+        return;
+    }
+    procModel_->appendTasks(std::move(tasks));
+}
 
-    for (int i = 0; i < procTable_->rowCount(); i++) {
-        bool ok1, ok2, ok3;
-        int pid = procTable_->item(i, 0)->text().toInt(&ok1);
-        int arrival = procTable_->item(i, 1)->text().toInt(&ok2);
-        int burst = procTable_->item(i, 2)->text().toInt(&ok3);
-        if (ok1 && ok2 && ok3)
-            tasks.emplace_back(pid, arrival, burst);
+void MainWindow::onFilterChanged() {
+    QString text = filterEdit_->text().trimmed();
+    filterEdit_->setStyleSheet("");
+    if (text.isEmpty()) {
+        procModel_->clearFilter();
+        return;
+    }
+
+    QStringList parts = text.split('-');
+    bool ok1, ok2 = true;
+    int lo = parts[0].trimmed().toInt(&ok1);
+    int hi = parts.size() > 1 ? parts[1].trimmed().toInt(&ok2) : lo;
+    if (!ok1 || !ok2 || parts.size() > 2) {
+        // show everything rather than a stale filter the box no longer describes
+        filterEdit_->setStyleSheet("color: red;");
+        procModel_->clearFilter();
+        return;
     }
 
+    procModel_->setFilter(filterColumn_->currentIndex(), lo, hi);
+}
+
+void MainWindow::onRunClicked() {
+    const std::vector<Task> &tasks = procModel_->tasks();
     if (tasks.empty()) return;
 
+    int max_time = completion_horizon(tasks);
     Result res;
     if (algoCombo_->currentText() == "FCFS") {
         FCFS sched;
-        res = simulate(tasks, sched, 200);
+        res = simulate(tasks, sched, max_time);
     }else if(algoCombo_->currentText() == "SJF") {
         SJF sched;
         std::unordered_map<int,int> bm;
         for (auto &t : tasks) bm[t.pid] = t.burst;
         sched.set_bursts(bm);
-        res = simulate(tasks, sched, 200);
+        res = simulate(tasks, sched, max_time);
     } else if(algoCombo_->currentText() == "SRTF") {
         SRTF sched;
-        res = simulate(tasks, sched, 200);
+        res = simulate(tasks, sched, max_time);
     } else {
         int q = quantumSpin_->value();
         RoundRobin sched(q);
-        res = simulate(tasks, sched, 200);
+        res = simulate(tasks, sched, max_time);
     }
 
     gantt_->setResult(res);
@@ -6,7 +6,10 @@
 #include <QSpinBox>
 #include <QPushButton>
 #include <QTableWidget>
+#include <QTableView>
+#include <QLineEdit>
 #include "ganttwidget.hpp"
+#include "processmodel.hpp"
 #include <QHeaderView>
 
 class MainWindow : public QMainWindow {
@@ -19,6 +22,8 @@ private slots:
     void onAlgoChanged(int idx);
     void onAddProcess();
     void onDeleteProcess();
+    void onImportTrace();
+    void onFilterChanged();
     void onExportCSV();
     void onExportPNG();
     void onExportPDF();
@@ -31,9 +36,13 @@ private:
     QPushButton *exportPdfBtn_;
     GanttWidget *gantt_;
     QTableWidget *statsTable_;
-    QTableWidget *procTable_;
+    QTableView *procTable_;
+    ProcessModel *procModel_;
     QPushButton *addRowBtn_;
     QPushButton *delRowBtn_;
+    QPushButton *importBtn_;
+    QComboBox *filterColumn_;
+    QLineEdit *filterEdit_;
     Result lastResult_;
 };
 
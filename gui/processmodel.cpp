@@ -0,0 +1,184 @@
+#include "processmodel.hpp"
+#include <algorithm>
+#include <unordered_set>
+
+static int field(const Task &t, int column) {
+    switch (column) {
+    case ProcessModel::Pid: return t.pid;
+    case ProcessModel::Arrival: return t.arrival;
+    default: return t.burst;
+    }
+}
+
+ProcessModel::ProcessModel(QObject *parent) : QAbstractTableModel(parent) {}
+
+int ProcessModel::rowCount(const QModelIndex &parent) const {
+    if (parent.isValid()) return 0;
+    return filterColumn_ < 0 ? (int)tasks_.size() : (int)view_.size();
+}
+
+int ProcessModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant ProcessModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || (role != Qt::DisplayRole && role != Qt::EditRole))
+        return QVariant();
+    return field(tasks_[sourceRow(index.row())], index.column());
+}
+
+QVariant ProcessModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole) return QVariant();
+    if (orientation == Qt::Vertical) return section + 1;
+    switch (section) {
+    case Pid: return QStringLiteral("PID");
+    case Arrival: return QStringLiteral("Arrival Time");
+    case Burst: return QStringLiteral("Burst Time");
+    }
+    return QVariant();
+}
+
+Qt::ItemFlags ProcessModel::flags(const QModelIndex &index) const {
+    if (!index.isValid()) return Qt::NoItemFlags;
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemIsEditable;
+}
+
+bool ProcessModel::setData(const QModelIndex &index, const QVariant &value, int role) {
+    if (!index.isValid() || role != Qt::EditRole) return false;
+
+    bool ok;
+    int v = value.toInt(&ok);
+    if (!ok) return false;
+
+    Task &t = tasks_[sourceRow(index.row())];
+    switch (index.column()) {
+    case Pid:
+        if (v != t.pid && hasPid(v)) return false;
+        t.pid = v;
+        break;
+    case Arrival:
+        if (v < 0) return false;
+        t.arrival = v;
+        break;
+    case Burst:
+        if (v <= 0) return false;
+        t.burst = t.remaining = v;
+        break;
+    default:
+        return false;
+    }
+
+    // an edit that takes the row out of the filter's range hides it
+    if (filterColumn_ == index.column() && !matches(t)) {
+        beginRemoveRows(QModelIndex(), index.row(), index.row());
+        view_.erase(view_.begin() + index.row());
+        endRemoveRows();
+        return true;
+    }
+    emit dataChanged(index, index, {Qt::DisplayRole, Qt::EditRole});
+    return true;
+}
+
+void ProcessModel::sort(int column, Qt::SortOrder order) {
+    if (column < 0 || column >= ColumnCount) return;
+    beginResetModel();
+    std::stable_sort(tasks_.begin(), tasks_.end(), [=](const Task &a, const Task &b){
+        return order == Qt::AscendingOrder ? field(a, column) < field(b, column)
+                                           : field(b, column) < field(a, column);
+    });
+    rebuildView();
+    endResetModel();
+}
+
+void ProcessModel::appendTask(const Task &t) {
+    appendTasks({t});
+}
+
+void ProcessModel::appendTasks(std::vector<Task> tasks) {
+    if (tasks.empty()) return;
+
+    if (filterColumn_ >= 0) {
+        beginResetModel();
+        tasks_.insert(tasks_.end(), tasks.begin(), tasks.end());
+        rebuildView();
+        endResetModel();
+        return;
+    }
+
+    int first = tasks_.size();
+    beginInsertRows(QModelIndex(), first, first + (int)tasks.size() - 1);
+    if (tasks_.empty())
+        tasks_ = std::move(tasks);
+    else
+        tasks_.insert(tasks_.end(), tasks.begin(), tasks.end());
+    endInsertRows();
+}
+
+void ProcessModel::removeTaskRows(std::vector<int> rows) {
+    if (rows.empty()) return;
+
+    if (rows.size() == 1 && filterColumn_ < 0) {
+        beginRemoveRows(QModelIndex(), rows[0], rows[0]);
+        tasks_.erase(tasks_.begin() + rows[0]);
+        endRemoveRows();
+        return;
+    }
+
+    std::vector<char> drop(tasks_.size(), 0);
+    for (int r : rows) drop[sourceRow(r)] = 1;
+
+    beginResetModel();
+    size_t i = 0;
+    tasks_.erase(std::remove_if(tasks_.begin(), tasks_.end(), [&](const Task &){
+        return drop[i++];
+    }), tasks_.end());
+    rebuildView();
+    endResetModel();
+}
+
+int ProcessModel::nextPid() const {
+    int pid = 0;
+    for (auto &t : tasks_) pid = std::max(pid, t.pid);
+    return pid + 1;
+}
+
+bool ProcessModel::hasPid(int pid) const {
+    return std::any_of(tasks_.begin(), tasks_.end(), [=](const Task &t){ return t.pid == pid; });
+}
+
+bool ProcessModel::sharesPids(const std::vector<Task> &tasks) const {
+    std::unordered_set<int> pids;
+    pids.reserve(tasks_.size());
+    for (auto &t : tasks_) pids.insert(t.pid);
+    return std::any_of(tasks.begin(), tasks.end(), [&](const Task &t){ return pids.count(t.pid) > 0; });
+}
+
+void ProcessModel::setFilter(int column, int lo, int hi) {
+    beginResetModel();
+    filterColumn_ = column;
+    filterLo_ = lo;
+    filterHi_ = hi;
+    rebuildView();
+    endResetModel();
+}
+
+void ProcessModel::clearFilter() {
+    if (filterColumn_ < 0) return;
+    beginResetModel();
+    filterColumn_ = -1;
+    view_.clear();
+    view_.shrink_to_fit();
+    endResetModel();
+}
+
+bool ProcessModel::matches(const Task &t) const {
+    int v = field(t, filterColumn_);
+    return v >= filterLo_ && v <= filterHi_;
+}
+
+void ProcessModel::rebuildView() {
+    view_.clear();
+    if (filterColumn_ < 0) return;
+    for (int i = 0; i < (int)tasks_.size(); i++)
+        if (matches(tasks_[i])) view_.push_back(i);
+}
@@ -0,0 +1,49 @@
+#ifndef PROCESSMODEL_HPP
+#define PROCESSMODEL_HPP
+
+#include <QAbstractTableModel>
+#include <vector>
+#include "scheduler.hpp"
+
+// Table model over the workload itself; tasks() is what gets simulated.
+// Filtering keeps a list of matching rows instead of copying tasks.
+class ProcessModel : public QAbstractTableModel {
+    Q_OBJECT
+public:
+    enum Column { Pid, Arrival, Burst, ColumnCount };
+
+    explicit ProcessModel(QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    const std::vector<Task> &tasks() const { return tasks_; }
+    void appendTask(const Task &t);
+    void appendTasks(std::vector<Task> tasks);
+    void removeTaskRows(std::vector<int> rows);
+    int nextPid() const;
+    bool hasPid(int pid) const;
+    bool sharesPids(const std::vector<Task> &tasks) const;
+
+    void setFilter(int column, int lo, int hi);
+    void clearFilter();
+    bool isFiltered() const { return filterColumn_ >= 0; }
+
+private:
+    int sourceRow(int row) const { return filterColumn_ < 0 ? row : view_[row]; }
+    bool matches(const Task &t) const;
+    void rebuildView();
+
+    std::vector<Task> tasks_;
+    std::vector<int> view_;
+    int filterColumn_ = -1;
+    int filterLo_ = 0;
+    int filterHi_ = 0;
+};
+
+#endif
@@ -3,30 +3,41 @@
 
 #include "scheduler.hpp"
 #include <queue>
+#include <deque>
 #include <unordered_map>
 #include <algorithm>
 
+using PidQueue = std::queue<int, std::pmr::deque<int>>;
+
 class FCFS : public Scheduler {
-    std::queue<int>q;
+    PidQueue q;
 public:
+    explicit FCFS(std::pmr::memory_resource *mr = std::pmr::get_default_resource())
+        : q(std::pmr::deque<int>(mr)) {}
+
     void add_task(int pid) {
-        q.push(pid); 
+        q.push(pid);
     }
 
     int pick_next(int now) {
         if (q.empty()) return -1;
-        int pid = q.front(); 
+        int pid = q.front();
         q.pop();
         return pid;
     }
+
+    void reset() override {
+        while (!q.empty()) q.pop();
+    }
 };
 
 class RoundRobin : public Scheduler {
-    std::queue<int> rq;
-    std::unordered_map<int,int> slice_used;
+    PidQueue rq;
+    std::pmr::unordered_map<int,int> slice_used;
     int quantum;
 public:
-    RoundRobin(int q) : quantum(q) {}
+    RoundRobin(int q, std::pmr::memory_resource *mr = std::pmr::get_default_resource())
+        : rq(std::pmr::deque<int>(mr)), slice_used(mr), quantum(q) {}
     void add_task(int pid) {
         rq.push(pid);
         slice_used[pid] = 0;
@@ -38,12 +49,18 @@ public:
     }
     void requeue(int pid) { rq.push(pid); }
     int get_quantum() const { return quantum; }
+    void reset() override {
+        while (!rq.empty()) rq.pop();
+        slice_used.clear();
+    }
 };
 
 class SJF : public Scheduler {
-    std::vector<int> ready;
-    std::unordered_map<int,int> burst_map;
+    std::pmr::vector<int> ready;
+    std::pmr::unordered_map<int,int> burst_map;
 public:
+    explicit SJF(std::pmr::memory_resource *mr = std::pmr::get_default_resource())
+        : ready(mr), burst_map(mr) {}
     void add_task(int pid) override {
         ready.push_back(pid);
     }
@@ -55,13 +72,19 @@ public:
         ready.erase(std::remove(ready.begin(), ready.end(), pid), ready.end());
         return pid;
     }
-    void set_bursts(const std::unordered_map<int,int>& m){ burst_map = m; }
+    void set_bursts(const std::unordered_map<int,int>& m){
+        burst_map.clear();
+        burst_map.insert(m.begin(), m.end());
+    }
+    void reset() override { ready.clear(); }
 };
 
 class SRTF : public Scheduler {
-    std::vector<int> ready;
-    std::unordered_map<int,int> remaining;
+    std::pmr::vector<int> ready;
+    std::pmr::unordered_map<int,int> remaining;
 public:
+    explicit SRTF(std::pmr::memory_resource *mr = std::pmr::get_default_resource())
+        : ready(mr), remaining(mr) {}
     void add_task(int pid) override {
         ready.push_back(pid);
     }
@@ -74,6 +97,10 @@ public:
         return pid;
     }
     void update_remaining(int pid, int rem){ remaining[pid] = rem; }
+    void reset() override {
+        ready.clear();
+        remaining.clear();
+    }
 };
 
 
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <unordered_map>
+#include <memory_resource>
 #include <string>
 #include <utility>
 
@@ -31,9 +32,9 @@ struct Event {
 };
 
 struct Result {
-    std::vector<Event> events;
-    std::unordered_map<int, Task> tasks;
-    std::unordered_map<int, std::vector<std::pair<int,int>>> run_intervals;
+    std::pmr::vector<Event> events;
+    std::pmr::unordered_map<int, Task> tasks;
+    std::pmr::unordered_map<int, std::pmr::vector<std::pair<int,int>>> run_intervals;
 
     int total_ticks = 0;
     int context_switches = 0;
@@ -44,6 +45,9 @@ struct Result {
     double avg_response = 0;
     double cpu_utilization = 0;
     double throughput = 0;
+
+    Result() = default;
+    explicit Result(std::pmr::memory_resource *mr) : events(mr), tasks(mr), run_intervals(mr) {}
 };
 
 class Scheduler {
@@ -51,6 +55,7 @@ public:
     virtual void add_task(int pid) = 0;
     virtual int pick_next(int now) = 0;
     virtual void on_tick(int now, int pid) {}
+    virtual void reset() {}
     virtual ~Scheduler() {}
 };
 
@@ -1,138 +1,269 @@
 #include "simulator.hpp"
 #include "implementation.hpp"
 #include <algorithm>
+#include <climits>
 
-Result simulate(std::vector<Task> tasks, Scheduler &sched, int max_time) {
-    Result res;
+static bool by_arrival(const Task &a, const Task &b) {
+    return a.arrival < b.arrival;
+}
 
-    std::sort(tasks.begin(), tasks.end(), [](auto &a, auto &b){
-        return a.arrival < b.arrival;
-    });
+Simulation::Simulation(Scheduler &sched, std::size_t queue_capacity, std::pmr::memory_resource *mr)
+    : sched_(&sched),
+      rr_(dynamic_cast<RoundRobin*>(&sched)),
+      srt_(dynamic_cast<SRTF*>(&sched)),
+      arrivals_(queue_capacity),
+      work_(mr),
+      tmap_(mr),
+      res_(mr) {}
 
-    std::unordered_map<int, Task*> tmap;
-    for (auto &t: tasks) tmap[t.pid] = &t;
+bool Simulation::offer(const Task &t) {
+    if (!arrivals_.try_push(t)) return false;
+    watermark_.store(t.arrival, std::memory_order_release);
+    return true;
+}
 
-    int n = tasks.size();
-    int ai = 0;             
-    int finished = 0;
-    int now = 0;
-    int running = -1;
-    int quantum_used = 0;
+void Simulation::close() {
+    closed_.store(true, std::memory_order_release);
+}
 
-    RoundRobin *rr = dynamic_cast<RoundRobin*>(&sched);
-    SRTF *srt = dynamic_cast<SRTF*>(&sched);
+void Simulation::submit(const Task &t) {
+    if (work_.size() == ai_ || work_.back().arrival <= t.arrival) {
+        work_.push_back(t);
+        return;
+    }
+    auto it = std::upper_bound(work_.begin() + ai_, work_.end(), t, by_arrival);
+    work_.insert(it, t);
+}
 
-    int interval_start = -1;
+void Simulation::load(const std::vector<Task> &tasks) {
+    work_.insert(work_.end(), tasks.begin(), tasks.end());
+    std::sort(work_.begin() + ai_, work_.end(), by_arrival);
+}
 
-    while (now < max_time && finished < n) {
-        while (ai < n && tasks[ai].arrival <= now) {
-            sched.add_task(tasks[ai].pid);
-            res.tasks[tasks[ai].pid] = tasks[ai];
-            if (srt) srt->update_remaining(tasks[ai].pid, tasks[ai].remaining);
-            ai++;
-        }
+void Simulation::drain() {
+    arrivals_.consume_all([this](const Task &t){ submit(t); });
+}
 
-        if (running != -1 && srt) {
-            int cand = sched.pick_next(now); 
-            if (cand != -1) {
-                Task *t_cand = tmap[cand];
-                Task *t_run = tmap[running];
-                if (t_cand->remaining < t_run->remaining) {
-                    res.events.push_back({now, running, "preempt"});
-                    sched.add_task(running);
-                    if (interval_start != -1) res.run_intervals[running].push_back({interval_start, now});
-
-                    running = cand;
-                    quantum_used = 0;
-                    res.context_switches++;
-
-                    auto &t = *tmap[running];
-                    if (t.start_time == -1) {
-                        t.start_time = now;
-                        t.response_time = now - t.arrival;
-                    }
-                    res.events.push_back({now, running, "start"});
-                    interval_start = now;
-                } else {
-                    sched.add_task(cand);
-                }
-            }
-        }
+void Simulation::admit() {
+    while (ai_ < work_.size() && work_[ai_].arrival <= now_) {
+        Task &t = work_[ai_];
+        tmap_[t.pid] = ai_++;
+        sched_->add_task(t.pid);
+        if (srt_) srt_->update_remaining(t.pid, t.remaining);
+    }
+}
 
-        if (running == -1) {
-            running = sched.pick_next(now);
-            quantum_used = 0;
-
-            if (running != -1) {
-                auto &t = *tmap[running];
-                if (t.start_time == -1) {
-                    t.start_time = now;
-                    t.response_time = now - t.arrival;
-                }
-                res.events.push_back({now, running, "start"});
-                interval_start = now; 
+void Simulation::start(int pid) {
+    auto &t = work_[tmap_[pid]];
+    if (t.start_time == -1) {
+        t.start_time = now_;
+        t.response_time = now_ - t.arrival;
+        started_++;
+        total_resp_ += t.response_time;
+    }
+    res_.events.push_back({now_, pid, "start"});
+    interval_start_ = now_;
+}
+
+void Simulation::step() {
+    tick(now_ + 1);
+}
+
+void Simulation::tick(int limit) {
+    drain();
+    admit();
+
+    if (running_ != -1 && srt_) {
+        int cand = sched_->pick_next(now_);
+        if (cand != -1) {
+            Task *t_cand = &work_[tmap_[cand]];
+            Task *t_run = &work_[tmap_[running_]];
+            if (t_cand->remaining < t_run->remaining) {
+                res_.events.push_back({now_, running_, "preempt"});
+                sched_->add_task(running_);
+                if (interval_start_ != -1) res_.run_intervals[running_].push_back({interval_start_, now_});
+
+                running_ = cand;
+                quantum_used_ = 0;
+                res_.context_switches++;
+                start(running_);
+            } else {
+                sched_->add_task(cand);
             }
         }
+    }
 
-        if (running != -1) {
-            auto &t = *tmap[running];
-            t.remaining--;
-            if (srt) srt->update_remaining(t.pid, t.remaining);
-            res.cpu_busy++;
-            quantum_used++;
-            now++;
-
-            while (ai < n && tasks[ai].arrival <= now) {
-                sched.add_task(tasks[ai].pid);
-                res.tasks[tasks[ai].pid] = tasks[ai];
-                if (srt) srt->update_remaining(tasks[ai].pid, tasks[ai].remaining);
-                ai++;
-            }
+    if (running_ == -1) {
+        running_ = sched_->pick_next(now_);
+        quantum_used_ = 0;
+        if (running_ != -1) start(running_);
+    }
 
-            if (t.remaining == 0) {
-                t.completion_time = now;
-                t.turnaround_time = t.completion_time - t.arrival;
-                t.waiting_time = t.turnaround_time - t.burst;
-                res.events.push_back({now, running, "complete"});
-
-                if (interval_start != -1) res.run_intervals[running].push_back({interval_start, now});
-
-                running = -1;
-                finished++;
-            } else if (rr && quantum_used >= rr->get_quantum()) {
-                while (ai < n && tasks[ai].arrival <= now) {
-                    sched.add_task(tasks[ai].pid);
-                    res.tasks[tasks[ai].pid] = tasks[ai];
-                    if (srt) srt->update_remaining(tasks[ai].pid, tasks[ai].remaining);
-                    ai++;
-                }
-                res.events.push_back({now, running, "preempt"});
-                rr->requeue(running);
-                if (interval_start != -1) res.run_intervals[running].push_back({interval_start, now});
-
-                running = -1;
-                res.context_switches++;
-            }
-        } else {
-            now++; 
+    if (running_ == -1) {
+        // nothing is ready, so every tick up to the next arrival is idle
+        int next = ai_ < work_.size() ? work_[ai_].arrival : now_ + 1;
+        now_ = std::max(now_ + 1, std::min(next, limit));
+        return;
+    }
+
+    auto &t = work_[tmap_[running_]];
+    t.remaining--;
+    if (srt_) srt_->update_remaining(t.pid, t.remaining);
+    res_.cpu_busy++;
+    quantum_used_++;
+    now_++;
+
+    admit();
+
+    if (t.remaining == 0) {
+        t.completion_time = now_;
+        t.turnaround_time = t.completion_time - t.arrival;
+        t.waiting_time = t.turnaround_time - t.burst;
+        res_.events.push_back({now_, running_, "complete"});
+
+        if (interval_start_ != -1) res_.run_intervals[running_].push_back({interval_start_, now_});
+
+        running_ = -1;
+        finished_++;
+        total_wait_ += t.waiting_time;
+        total_tat_ += t.turnaround_time;
+    } else if (rr_ && quantum_used_ >= rr_->get_quantum()) {
+        res_.events.push_back({now_, running_, "preempt"});
+        rr_->requeue(running_);
+        if (interval_start_ != -1) res_.run_intervals[running_].push_back({interval_start_, now_});
+
+        running_ = -1;
+        res_.context_switches++;
+    }
+}
+
+void Simulation::advance_until(int t) {
+    while (now_ < t && !done()) {
+        // a tick admits arrivals up to now_ + 1; any of those still to come
+        // would be offered at or after the current watermark. Draining first
+        // frees ring space so a stalled producer can move it forward.
+        // An idle jump is held to the watermark for the same reason.
+        bool closed = closed_.load(std::memory_order_acquire);
+        drain();
+        int limit = t;
+        if (!closed) {
+            int watermark = watermark_.load(std::memory_order_acquire);
+            if (now_ + 1 >= watermark) return;
+            limit = std::min(limit, watermark);
         }
+        tick(limit);
     }
+}
+
+bool Simulation::done() const {
+    return closed_.load(std::memory_order_acquire) && arrivals_.empty()
+        && ai_ == work_.size() && finished_ == (int)ai_;
+}
+
+void Simulation::reset(Scheduler &sched) {
+    sched_ = &sched;
+    rr_ = dynamic_cast<RoundRobin*>(&sched);
+    srt_ = dynamic_cast<SRTF*>(&sched);
+    sched.reset();
+
+    arrivals_.consume_all([](const Task &){});
+    closed_.store(false, std::memory_order_relaxed);
+    watermark_.store(std::numeric_limits<int>::min(), std::memory_order_relaxed);
+
+    work_.clear();
+    ai_ = 0;
+    tmap_.clear();
 
-    res.total_ticks = now;
-    for (auto &t : tasks) res.tasks[t.pid] = t;
+    res_.events.clear();
+    res_.tasks.clear();
+    res_.run_intervals.clear();
+    res_.total_ticks = 0;
+    res_.context_switches = 0;
+    res_.cpu_busy = 0;
+
+    now_ = 0;
+    running_ = -1;
+    quantum_used_ = 0;
+    interval_start_ = -1;
+    finished_ = 0;
+    started_ = 0;
+    total_wait_ = total_tat_ = total_resp_ = 0;
+}
+
+Metrics Simulation::metrics() const {
+    Metrics m;
+    m.now = now_;
+    m.arrived = ai_;
+    m.finished = finished_;
+    m.running = running_;
+    m.cpu_busy = res_.cpu_busy;
+    m.context_switches = res_.context_switches;
+    if (finished_ > 0) {
+        m.avg_waiting = total_wait_ / finished_;
+        m.avg_turnaround = total_tat_ / finished_;
+    }
+    if (started_ > 0) m.avg_response = total_resp_ / started_;
+    if (now_ > 0) {
+        m.cpu_utilization = (double)res_.cpu_busy / now_ * 100.0;
+        m.throughput = (double)finished_ / now_;
+    }
+    return m;
+}
+
+Result Simulation::result() const {
+    Result res = res_;
+    summarize(res);
+    return res;
+}
+
+const Result &Simulation::finalize() {
+    summarize(res_);
+    return res_;
+}
+
+void Simulation::summarize(Result &res) const {
+    res.total_ticks = now_;
 
     double total_wait = 0, total_tat = 0, total_resp = 0;
-    for (auto &t : tasks) {
+    for (auto &t : work_) {
+        res.tasks[t.pid] = t;
         total_wait += t.waiting_time;
         total_tat += t.turnaround_time;
         total_resp += t.response_time;
     }
 
+    int n = work_.size();
     res.avg_waiting = total_wait / n;
     res.avg_turnaround = total_tat / n;
     res.avg_response = total_resp / n;
     res.cpu_utilization = (double)res.cpu_busy / res.total_ticks * 100.0;
     res.throughput = (double)n / res.total_ticks;
+}
 
-    return res;
+const Result &SimulationContext::run(const std::vector<Task> &tasks, Scheduler &sched, int max_time) {
+    if (sim_) sim_->reset(sched);
+    else sim_.emplace(sched, 2, &pool_);
+
+    sim_->load(tasks);
+    sim_->close();
+    sim_->advance_until(max_time);
+    return sim_->finalize();
+}
+
+Result simulate(const std::vector<Task> &tasks, Scheduler &sched, int max_time) {
+    Simulation sim(sched, 2);
+    sim.load(tasks);
+    sim.close();
+    sim.advance_until(max_time);
+
+    return sim.result();
+}
+
+int completion_horizon(const std::vector<Task> &tasks) {
+    long long last = 0, total = 0;
+    for (auto &t : tasks) {
+        last = std::max<long long>(last, t.arrival);
+        total += t.burst;
+    }
+    return (int)std::min<long long>(last + total, INT_MAX);
 }
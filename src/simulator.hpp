@@ -2,7 +2,115 @@
 #define SIMULATOR_HPP
 
 #include "scheduler.hpp"
+#include "spsc_ring.hpp"
+#include <atomic>
+#include <limits>
+#include <memory_resource>
+#include <optional>
 
-Result simulate(std::vector<Task> tasks, Scheduler &sched, int max_time=100);
+class RoundRobin;
+class SRTF;
+
+struct Metrics {
+    int now = 0;
+    int arrived = 0;
+    int finished = 0;
+    int running = -1;
+    int cpu_busy = 0;
+    int context_switches = 0;
+
+    double avg_waiting = 0;
+    double avg_turnaround = 0;
+    double avg_response = 0;
+    double cpu_utilization = 0;
+    double throughput = 0;
+};
+
+// Incremental form of simulate(). Arrivals either come from one producer
+// thread through offer()/close(), or are handed in directly with submit()
+// or load() from the thread that steps the simulation.
+//
+// offer() expects arrivals in non-decreasing time order. Until close(),
+// advance_until() never moves the clock past the latest offered arrival, so
+// a task still in flight is admitted on time rather than late. step() is
+// not held back and always runs one tick; advance_until() skips idle gaps
+// before an arrival it already holds in a single jump.
+class Simulation {
+public:
+    explicit Simulation(Scheduler &sched, std::size_t queue_capacity = 1 << 16,
+                        std::pmr::memory_resource *mr = std::pmr::get_default_resource());
+
+    bool offer(const Task &t);
+    void close();
+
+    void submit(const Task &t);
+    void load(const std::vector<Task> &tasks);
+    void step();
+    void advance_until(int t);
+    bool done() const;
+
+    // Drops all tasks and results but keeps their storage for the next run.
+    void reset(Scheduler &sched);
+
+    int now() const { return now_; }
+    Metrics metrics() const;
+    Result result() const;
+    // Like result(), but fills the simulation's own buffers instead of copying.
+    const Result &finalize();
+
+private:
+    // One tick, or an idle stretch ending at the next arrival or at limit.
+    void tick(int limit);
+    void drain();
+    void admit();
+    void start(int pid);
+    void summarize(Result &res) const;
+
+    Scheduler *sched_;
+    RoundRobin *rr_;
+    SRTF *srt_;
+
+    SpscRing<Task> arrivals_;
+    // written by the producer on every offer(), so kept off the lines the
+    // stepping thread writes
+    alignas(64) std::atomic<bool> closed_{false};
+    std::atomic<int> watermark_{std::numeric_limits<int>::min()};
+
+    // work_[0, ai_) have arrived, the rest are pending in arrival order
+    alignas(64) std::pmr::vector<Task> work_;
+    std::size_t ai_ = 0;
+    std::pmr::unordered_map<int, int> tmap_;
+    Result res_;
+
+    int now_ = 0;
+    int running_ = -1;
+    int quantum_used_ = 0;
+    int interval_start_ = -1;
+    int finished_ = 0;
+
+    int started_ = 0;
+    double total_wait_ = 0;
+    double total_tat_ = 0;
+    double total_resp_ = 0;
+};
+
+// Owns pooled storage for repeated runs. Schedulers built on resource()
+// and run through the same context allocate nothing once warmed up.
+class SimulationContext {
+public:
+    std::pmr::memory_resource *resource() { return &pool_; }
+    // The returned result stays valid until the next run.
+    const Result &run(const std::vector<Task> &tasks, Scheduler &sched, int max_time=100);
+
+private:
+    std::pmr::unsynchronized_pool_resource pool_;
+    std::optional<Simulation> sim_;
+};
+
+Result simulate(const std::vector<Task> &tasks, Scheduler &sched, int max_time=100);
+
+// A max_time by which every task has completed: the CPU never idles while
+// work is ready, so the last arrival plus the total burst is always enough.
+int completion_horizon(const std::vector<Task> &tasks);
 
 #endif
@@ -0,0 +1,78 @@
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+// Bounded single-producer/single-consumer queue. Indices run freely and are
+// masked on access; each side keeps a cached copy of the other's index so the
+// shared cache lines are only touched when the ring looks full or empty.
+template <typename T>
+class SpscRing {
+    static constexpr std::size_t line = 64;
+
+    alignas(line) std::atomic<std::size_t> head{0};
+    std::size_t tail_cache = 0;
+
+    alignas(line) std::atomic<std::size_t> tail{0};
+    std::size_t head_cache = 0;
+
+    alignas(line) std::size_t mask;
+    std::unique_ptr<T[]> buf;
+
+public:
+    explicit SpscRing(std::size_t capacity) {
+        std::size_t cap = 2;
+        while (cap < capacity) cap <<= 1;
+        mask = cap - 1;
+        buf = std::make_unique<T[]>(cap);
+    }
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    std::size_t capacity() const { return mask + 1; }
+
+    // producer only; returns false instead of waiting when the ring is full
+    bool try_push(const T &v) {
+        std::size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head_cache > mask) {
+            head_cache = head.load(std::memory_order_acquire);
+            if (t - head_cache > mask) return false;
+        }
+        buf[t & mask] = v;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer only
+    bool try_pop(T &out) {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        if (h == tail_cache) {
+            tail_cache = tail.load(std::memory_order_acquire);
+            if (h == tail_cache) return false;
+        }
+        out = buf[h & mask];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer only; hands every queued element to f and frees the slots in one store
+    template <typename F>
+    std::size_t consume_all(F &&f) {
+        std::size_t h = head.load(std::memory_order_relaxed);
+        tail_cache = tail.load(std::memory_order_acquire);
+        std::size_t n = tail_cache - h;
+        if (n == 0) return 0;
+        for (; h != tail_cache; ++h) f(buf[h & mask]);
+        head.store(h, std::memory_order_release);
+        return n;
+    }
+
+    bool empty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+};
+
+#endif
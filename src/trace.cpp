@@ -0,0 +1,80 @@
+#include "trace.hpp"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+
+static bool is_blank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static const char *skip_blanks(const char *p, const char *end) {
+    while (p < end && is_blank(*p)) p++;
+    return p;
+}
+
+void parse_trace(std::string_view text, std::vector<Task> &out) {
+    std::unordered_set<int> seen;
+    seen.reserve(out.size());
+    for (auto &t : out) seen.insert(t.pid);
+
+    int line_no = 0;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t eol = text.find('\n', pos);
+        if (eol == std::string_view::npos) eol = text.size();
+        std::string_view line = text.substr(pos, eol - pos);
+        pos = eol + 1;
+        line_no++;
+
+        const char *end = line.data() + line.size();
+        const char *p = skip_blanks(line.data(), end);
+        if (p == end || *p == '#' || std::isalpha((unsigned char)*p)) continue;
+
+        int v[3];
+        for (int i = 0; i < 3; i++) {
+            // a single comma between fields, so "1,,5" is an empty field
+            if (i > 0) {
+                p = skip_blanks(p, end);
+                if (p < end && *p == ',') p = skip_blanks(p + 1, end);
+            }
+            auto [next, ec] = std::from_chars(p, end, v[i]);
+            if (ec != std::errc() || (next < end && !is_blank(*next) && *next != ','))
+                throw std::runtime_error("trace line " + std::to_string(line_no) + ": expected pid, arrival, burst");
+            p = next;
+        }
+        if (v[1] < 0 || v[2] <= 0)
+            throw std::runtime_error("trace line " + std::to_string(line_no) + ": arrival must be >= 0 and burst > 0");
+        if (!seen.insert(v[0]).second)
+            throw std::runtime_error("trace line " + std::to_string(line_no) + ": duplicate pid " + std::to_string(v[0]));
+        out.emplace_back(v[0], v[1], v[2]);
+    }
+}
+
+void validate_tasks(const std::vector<Task> &tasks) {
+    std::unordered_set<int> seen;
+    seen.reserve(tasks.size());
+    for (size_t i = 0; i < tasks.size(); i++) {
+        const Task &t = tasks[i];
+        if (t.arrival < 0 || t.burst <= 0)
+            throw std::runtime_error("task " + std::to_string(i + 1) + ": arrival must be >= 0 and burst > 0");
+        if (!seen.insert(t.pid).second)
+            throw std::runtime_error("task " + std::to_string(i + 1) + ": duplicate pid " + std::to_string(t.pid));
+    }
+}
+
+std::vector<Task> load_trace(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::runtime_error("cannot open trace " + path);
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    std::string text = ss.str();
+
+    std::vector<Task> tasks;
+    tasks.reserve(std::count(text.begin(), text.end(), '\n') + 1);
+    parse_trace(text, tasks);
+    return tasks;
+}
@@ -0,0 +1,19 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include "scheduler.hpp"
+#include <string>
+#include <string_view>
+
+// One task per line: pid, arrival and burst separated by one comma or by
+// spaces. An empty field such as "1,,5" is an error rather than a shift.
+// Further columns are ignored, so CSV exports load back unchanged. Blank
+// lines, '#' comments and lines starting with a letter (headers) are skipped.
+// A pid may appear only once, counting tasks already in out.
+void parse_trace(std::string_view text, std::vector<Task> &out);
+std::vector<Task> load_trace(const std::string &path);
+
+// Applies the same rules to tasks that did not come from a trace.
+void validate_tasks(const std::vector<Task> &tasks);
+
+#endif
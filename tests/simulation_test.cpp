@@ -0,0 +1,119 @@
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <thread>
+#include "implementation.hpp"
+#include "simulator.hpp"
+
+// Feeds the same workloads through Simulation::offer() from a producer
+// thread, through one reused SimulationContext and through simulate(), and
+// checks that all of them give the same result.
+
+static std::unique_ptr<Scheduler> make_scheduler(int algo, const std::vector<Task> &tasks,
+        std::pmr::memory_resource *mr = std::pmr::get_default_resource()) {
+    switch (algo) {
+    case 0: return std::make_unique<FCFS>(mr);
+    case 1: return std::make_unique<RoundRobin>(2, mr);
+    case 2: {
+        auto sjf = std::make_unique<SJF>(mr);
+        std::unordered_map<int,int> bm;
+        for (auto &t : tasks) bm[t.pid] = t.burst;
+        sjf->set_bursts(bm);
+        return sjf;
+    }
+    default: return std::make_unique<SRTF>(mr);
+    }
+}
+
+static std::string describe(const Result &r) {
+    std::ostringstream out;
+    out << r.total_ticks << " " << r.context_switches << " " << r.cpu_busy << " "
+        << r.avg_waiting << " " << r.avg_turnaround << " " << r.avg_response << "\n";
+    for (auto &e : r.events) out << e.time << ":" << e.pid << ":" << e.type << " ";
+    out << "\n";
+
+    std::vector<int> pids;
+    for (auto &kv : r.tasks) pids.push_back(kv.first);
+    std::sort(pids.begin(), pids.end());
+    for (int pid : pids) {
+        const Task &t = r.tasks.at(pid);
+        out << pid << " " << t.start_time << " " << t.completion_time << " " << t.waiting_time << " |";
+        auto it = r.run_intervals.find(pid);
+        if (it != r.run_intervals.end())
+            for (auto &iv : it->second) out << " " << iv.first << "-" << iv.second;
+        out << "\n";
+    }
+    return out.str();
+}
+
+static Result run_live(const std::vector<Task> &sorted, int algo, std::mt19937 &gen) {
+    auto sched = make_scheduler(algo, sorted);
+    Simulation sim(*sched, 4);
+    std::thread producer([&]{
+        for (auto &t : sorted) {
+            while (!sim.offer(t)) std::this_thread::yield();
+            if (t.pid % 3 == 0) std::this_thread::yield();
+        }
+        sim.close();
+    });
+    while (!sim.done()) {
+        int before = sim.now();
+        sim.advance_until(before + 1 + gen() % 5);
+        if (sim.now() == before) std::this_thread::yield();
+    }
+    producer.join();
+    return sim.result();
+}
+
+int main() {
+    const char *names[] = {"FCFS", "RR", "SJF", "SRTF"};
+    std::mt19937 gen(2024);
+    int failures = 0;
+    SimulationContext ctx;
+
+    for (int iter = 0; iter < 200; iter++) {
+        int n = 1 + gen() % 30;
+        std::vector<Task> tasks;
+        for (int i = 0; i < n; i++)
+            tasks.emplace_back(i + 1, gen() % 40, 1 + gen() % 6);
+
+        // the producer offers tasks in the order simulate() itself sorts them
+        std::vector<Task> sorted = tasks;
+        std::sort(sorted.begin(), sorted.end(), [](auto &a, auto &b){
+            return a.arrival < b.arrival;
+        });
+
+        for (int algo = 0; algo < 4; algo++) {
+            auto sched = make_scheduler(algo, tasks);
+            std::string batch = describe(simulate(tasks, *sched, 1 << 20));
+            std::string live = describe(run_live(sorted, algo, gen));
+            if (batch != live) {
+                std::cerr << names[algo] << " mismatch on workload " << iter << "\nbatch:\n"
+                          << batch << "live:\n" << live;
+                failures++;
+            }
+
+            // the context is shared by every workload, algorithm and cut-off
+            int max_time = iter % 2 ? 1 << 20 : 1 + gen() % (completion_horizon(tasks) + 1);
+            auto fresh = make_scheduler(algo, tasks);
+            auto pooled = make_scheduler(algo, tasks, ctx.resource());
+            std::string expected = describe(simulate(tasks, *fresh, max_time));
+            std::string reused = describe(ctx.run(tasks, *pooled, max_time));
+            if (expected != reused) {
+                std::cerr << names[algo] << " context mismatch on workload " << iter
+                          << " max_time " << max_time << "\nsimulate:\n" << expected
+                          << "context:\n" << reused;
+                failures++;
+            }
+        }
+    }
+
+    if (failures) {
+        std::cerr << failures << " mismatches\n";
+        return 1;
+    }
+    std::cout << "live, reused and batch results match\n";
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "trace.hpp"
+
+// Checks which trace texts parse_trace() accepts and what it reads from them.
+
+static int failures = 0;
+
+static std::string describe(const std::vector<Task> &tasks) {
+    std::string out;
+    for (auto &t : tasks)
+        out += std::to_string(t.pid) + ":" + std::to_string(t.arrival) + ":" + std::to_string(t.burst) + " ";
+    return out;
+}
+
+static void accepts(const char *name, std::string_view text, const std::string &expected) {
+    std::vector<Task> tasks;
+    try {
+        parse_trace(text, tasks);
+    } catch (const std::runtime_error &e) {
+        std::cerr << name << ": unexpected error: " << e.what() << "\n";
+        failures++;
+        return;
+    }
+    if (describe(tasks) != expected) {
+        std::cerr << name << ": got \"" << describe(tasks) << "\", expected \"" << expected << "\"\n";
+        failures++;
+    }
+}
+
+static void rejects(const char *name, std::string_view text, const std::string &message,
+                    std::vector<Task> tasks = {}) {
+    try {
+        parse_trace(text, tasks);
+    } catch (const std::runtime_error &e) {
+        if (e.what() != message) {
+            std::cerr << name << ": got error \"" << e.what() << "\", expected \"" << message << "\"\n";
+            failures++;
+        }
+        return;
+    }
+    std::cerr << name << ": accepted, expected \"" << message << "\"\n";
+    failures++;
+}
+
+int main() {
+    accepts("commas", "1,0,5\n2,3,2\n", "1:0:5 2:3:2 ");
+    accepts("spaces", "1 0 5\n2\t3  2", "1:0:5 2:3:2 ");
+    accepts("spaces around commas", "1 , 0,  5\n", "1:0:5 ");
+    accepts("header and comments", "pid,arrival,burst\n# note\n\n   \n1,0,5\n", "1:0:5 ");
+    accepts("crlf", "pid,arrival,burst\r\n1,0,5\r\n2,1,3\r\n\r\n", "1:0:5 2:1:3 ");
+    accepts("extra columns", "1,0,5,3,10\n2 1 3 high\n", "1:0:5 2:1:3 ");
+
+    const std::string shape = ": expected pid, arrival, burst";
+    rejects("empty arrival", "1,,0,5\n", "trace line 1" + shape);
+    rejects("empty burst", "pid,arrival,burst\n3,4,,2\n", "trace line 2" + shape);
+    rejects("leading comma", ",1,0,5\n", "trace line 1" + shape);
+    rejects("missing burst", "1,0\n", "trace line 1" + shape);
+    rejects("trailing garbage", "1,0,5x\n", "trace line 1" + shape);
+    rejects("bad values", "1,0,0\n", "trace line 1: arrival must be >= 0 and burst > 0");
+    rejects("negative arrival", "1,-2,3\n", "trace line 1: arrival must be >= 0 and burst > 0");
+    rejects("duplicate pid", "1,0,5\n2,1,1\n1,4,2\n", "trace line 3: duplicate pid 1");
+    rejects("pid already loaded", "4,0,1\n", "trace line 1: duplicate pid 4", {Task(4, 0, 2)});
+
+    if (failures) {
+        std::cerr << failures << " trace cases failed\n";
+        return 1;
+    }
+    std::cout << "trace parsing cases pass\n";
+    return 0;
+}